@@ -1,14 +1,26 @@
 #include "digits.h"
 
 // Define private
-// Size of the digit boxes
-#define BOX_X 72
-#define BOX_Y 84
-
 // Animation duration and delay between in and out animations
 #define ANIM_DURATION 500
 #define ANIM_DELAY 300
 
+/**
+ * Per-platform tile sizes come from the wscript, which also scales the digit
+ * images to BOX_X by BOX_Y. Screen sizes come from the SDK
+ */
+#if !defined(BOX_X) || !defined(BOX_Y)
+#error "BOX_X and BOX_Y must be defined by the wscript"
+#endif
+
+#define SCREEN_X PBL_DISPLAY_WIDTH
+#define SCREEN_Y PBL_DISPLAY_HEIGHT
+
+// The block of tiles is centered when it does not fill the screen, which on
+// round displays keeps it inside the visible circle
+#define ORIGIN_X ((SCREEN_X - 2 * BOX_X) / 2)
+#define ORIGIN_Y ((SCREEN_Y - 2 * BOX_Y) / 2)
+
 /**
  * Type for digit position values structure
  */
@@ -17,10 +29,10 @@ const struct
     int out_of_frame[2];
     int in_frame[2];
 } DIGIT_POSITION_VALUES[4] = {
-    {{-144, 0}, {0, 0}},   // top-left
-    {{72, -168}, {72, 0}}, // top-right
-    {{0, 252}, {0, 84}},   // bottom-left
-    {{216, 84}, {72, 84}}  // bottom-right
+    {{ORIGIN_X - SCREEN_X, ORIGIN_Y}, {ORIGIN_X, ORIGIN_Y}},                                 // top-left
+    {{ORIGIN_X + BOX_X, ORIGIN_Y - SCREEN_Y}, {ORIGIN_X + BOX_X, ORIGIN_Y}},                 // top-right
+    {{ORIGIN_X, ORIGIN_Y + BOX_Y + SCREEN_Y}, {ORIGIN_X, ORIGIN_Y + BOX_Y}},                 // bottom-left
+    {{ORIGIN_X + BOX_X + SCREEN_X, ORIGIN_Y + BOX_Y}, {ORIGIN_X + BOX_X, ORIGIN_Y + BOX_Y}} // bottom-right
 };
 
 /**
@@ -29,6 +41,8 @@ const struct
 typedef struct
 {
     MaterialLayer material;
+    GBitmap *next_bitmap;
+    int next_value;
     PropertyAnimation *animation;
     bool out_of_frame;
     int position;
@@ -67,6 +81,11 @@ static const int DIGIT_RESOURCE_IDS[] = {
 DigitLayers *digit_layers = NULL;
 void animate_digit_layer(DigitLayer *digit_layer);
 
+/**
+ * Called whenever a digit finishes sliding into frame
+ */
+static DigitLandedHandler landed_handler = NULL;
+
 /**
  * Return the DigitLayer for the given digit value
  * @param digit Digit to return an associated DigitLayer from
@@ -96,20 +115,61 @@ DigitLayer *get_digit_layer_for_digit(DIGIT digit)
 }
 
 /**
- * Adds the next appropriate bitmap to the DigitLayer based on its internal time value
- * @param digit_layer The DigitLayer to update
+ * Loads the bitmap for a value as it should be displayed in the DigitLayer's position
+ * @param digit_layer The DigitLayer the bitmap is for
+ * @param value Value to load the bitmap for
  */
-void update_digit_layer_bitmap(DigitLayer *digit_layer)
+GBitmap *create_digit_layer_bitmap(DigitLayer *digit_layer, int value)
 {
-    gbitmap_destroy_safe(digit_layer->material.bitmap);
-    digit_layer->material.bitmap = gbitmap_create_with_resource(DIGIT_RESOURCE_IDS[digit_layer->value]);
+    GBitmap *bitmap = gbitmap_create_with_resource(DIGIT_RESOURCE_IDS[value]);
 #ifdef PBL_BW
     if (digit_layer->position == 1 || digit_layer->position == 2)
-        invert_bitmap(digit_layer->material.bitmap);
+        invert_bitmap(bitmap);
 #endif
+    return bitmap;
+}
+
+/**
+ * Adds the next appropriate bitmap to the DigitLayer based on its internal time value.
+ * Uses the preloaded bitmap if one was loaded for that value
+ * @param digit_layer The DigitLayer to update
+ */
+void update_digit_layer_bitmap(DigitLayer *digit_layer)
+{
+    gbitmap_destroy_safe(digit_layer->material.bitmap);
+    if (digit_layer->next_bitmap && digit_layer->next_value == digit_layer->value)
+    {
+        digit_layer->material.bitmap = digit_layer->next_bitmap;
+        digit_layer->next_bitmap = NULL;
+    }
+    else
+    {
+        gbitmap_destroy_safe(digit_layer->next_bitmap);
+        digit_layer->material.bitmap = create_digit_layer_bitmap(digit_layer, digit_layer->value);
+    }
     bitmap_layer_set_bitmap(digit_layer->material.bitmap_layer, digit_layer->material.bitmap);
 }
 
+/**
+ * Loads the bitmap for a digit's upcoming value ahead of time, so swapping it in
+ * while the digit is out of frame does not have to read the resource
+ * @param digit Digit the value will be shown on
+ * @param value Value to preload the bitmap for
+ */
+void preload_digit_bitmap(DIGIT digit, int value)
+{
+    DigitLayer *digit_layer = get_digit_layer_for_digit(digit);
+    if (!digit_layer)
+        return;
+
+    if (digit_layer->next_bitmap && digit_layer->next_value == value)
+        return;
+
+    gbitmap_destroy_safe(digit_layer->next_bitmap);
+    digit_layer->next_bitmap = create_digit_layer_bitmap(digit_layer, value);
+    digit_layer->next_value = value;
+}
+
 /**
  * Adds the next appropriate bitmap to the DigitLayer based on its internal time value
  * @param digit Digit to update on the clock
@@ -150,6 +210,24 @@ int get_digit_value(DIGIT digit)
     return digit_layer->value;
 }
 
+/**
+ * Return the time in milliseconds from the start of a digit's out animation
+ * until it is back in frame
+ */
+int get_digit_transition_ms()
+{
+    return 2 * (ANIM_DELAY + ANIM_DURATION);
+}
+
+/**
+ * Set the handler called whenever a digit finishes sliding into frame
+ * @param handler Handler to call, or NULL to clear it
+ */
+void set_digit_landed_handler(DigitLandedHandler handler)
+{
+    landed_handler = handler;
+}
+
 /**
  * Handles the completion of an animation
  * @param animation Pointer to the Animation that stopped
@@ -166,6 +244,10 @@ void anim_stopped_handler(Animation *animation, bool finished, void *context)
             update_digit_layer_bitmap(digit_layer);
             animate_digit_layer(digit_layer);
         }
+        else if (landed_handler)
+        {
+            landed_handler((DIGIT)digit_layer->position);
+        }
     }
 }
 
@@ -260,20 +342,21 @@ void add_digit_layers_to_layer(Layer *layer)
 
 /**
  * Initial load of digit layers
+ * @param in_frame Whether to place the digits in frame rather than out of frame ready for the intro
  */
-void load_digit_layers()
+void load_digit_layers(bool in_frame)
 {
     DigitLayer *digit_layer_array[4] = {digit_layers->hour1, digit_layers->hour2, digit_layers->minute1, digit_layers->minute2};
     for (int i = 0; i < 4; i++)
     {
         DigitLayer *digit_layer = digit_layer_array[i];
         digit_layer->position = i;
-        digit_layer->out_of_frame = true;
+        digit_layer->out_of_frame = !in_frame;
 
-        digit_layer->material.parent_layer = layer_create(GRect(
-            DIGIT_POSITION_VALUES[i].out_of_frame[0],
-            DIGIT_POSITION_VALUES[i].out_of_frame[1],
-            BOX_X, BOX_Y));
+        const int *origin = in_frame
+                                ? DIGIT_POSITION_VALUES[i].in_frame
+                                : DIGIT_POSITION_VALUES[i].out_of_frame;
+        digit_layer->material.parent_layer = layer_create(GRect(origin[0], origin[1], BOX_X, BOX_Y));
 
         digit_layer->material.bitmap_layer = bitmap_layer_create(GRect(0, 0, BOX_X, BOX_Y));
         update_digit_layer_bitmap(digit_layer);
@@ -293,6 +376,7 @@ void unload_digit_layers()
         layer_destroy_safe(digit_layer_array[i]->material.parent_layer);
         bitmap_layer_destroy_safe(digit_layer_array[i]->material.bitmap_layer);
         gbitmap_destroy_safe(digit_layer_array[i]->material.bitmap);
+        gbitmap_destroy_safe(digit_layer_array[i]->next_bitmap);
     }
 }
 
@@ -301,10 +385,10 @@ void unload_digit_layers()
  */
 void init_digit_layers()
 {
-    DigitLayer *digit_layer_hour1 = malloc(sizeof(DigitLayer));
-    DigitLayer *digit_layer_hour2 = malloc(sizeof(DigitLayer));
-    DigitLayer *digit_layer_minute1 = malloc(sizeof(DigitLayer));
-    DigitLayer *digit_layer_minute2 = malloc(sizeof(DigitLayer));
+    DigitLayer *digit_layer_hour1 = calloc(1, sizeof(DigitLayer));
+    DigitLayer *digit_layer_hour2 = calloc(1, sizeof(DigitLayer));
+    DigitLayer *digit_layer_minute1 = calloc(1, sizeof(DigitLayer));
+    DigitLayer *digit_layer_minute2 = calloc(1, sizeof(DigitLayer));
 
     digit_layers = malloc(sizeof(DigitLayers));
     digit_layers->hour1 = digit_layer_hour1;
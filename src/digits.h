@@ -11,11 +11,19 @@ typedef enum
     MINUTE2
 } DIGIT;
 
+/**
+ * Handler called when a digit has finished sliding into frame
+ */
+typedef void (*DigitLandedHandler)(DIGIT digit);
+
 void animate_digit(DIGIT digit);
 void update_digit_value(DIGIT digit, int value);
 int get_digit_value(DIGIT digit);
 void add_digit_layers_to_layer(Layer *layer);
-void load_digit_layers();
+void load_digit_layers(bool in_frame);
 void unload_digit_layers();
 void init_digit_layers();
-void update_digit_bitmap(DIGIT digit);
\ No newline at end of file
+void update_digit_bitmap(DIGIT digit);
+void preload_digit_bitmap(DIGIT digit, int value);
+int get_digit_transition_ms();
+void set_digit_landed_handler(DigitLandedHandler handler);
\ No newline at end of file
@@ -16,15 +16,34 @@ static void timer_callback(void *data)
 static void register_idle_timer()
 {
   idle = false;
+  idle_deadline = time(NULL) + 180;
   app_timer_cancel(timer);
   timer = app_timer_register(180 * 1000, timer_callback, NULL);
 }
 
 /**
- * Updates the time and triggers animations based on given time
- * @param t tm struct representing the time to update the clock to
+ * Restore the idle state saved in the snapshot, keeping the remaining time on the idle timer
  */
-static void update_time(struct tm *t)
+static void restore_idle_timer()
+{
+  int remaining = (int)(snapshot.idle_deadline - time(NULL));
+  if ((snapshot.flags & SNAPSHOT_FLAG_IDLE) || remaining <= 0)
+  {
+    idle = true;
+    return;
+  }
+
+  idle = false;
+  idle_deadline = snapshot.idle_deadline;
+  timer = app_timer_register(remaining * 1000, timer_callback, NULL);
+}
+
+/**
+ * Computes the value of each digit for a given time
+ * @param t tm struct representing the time to compute the digits for
+ * @param values Array indexed by DIGIT to write the values to
+ */
+static void get_time_digit_values(struct tm *t, int values[4])
 {
   int hour = t->tm_hour;
   if (!clock_is_24h_style())
@@ -34,6 +53,21 @@ static void update_time(struct tm *t)
       hour = 12;
   }
 
+  values[HOUR1] = hour / 10;
+  values[HOUR2] = hour % 10;
+  values[MINUTE1] = t->tm_min / 10;
+  values[MINUTE2] = t->tm_min % 10;
+}
+
+/**
+ * Updates the time and triggers animations based on given time
+ * @param t tm struct representing the time to update the clock to
+ */
+static void update_time(struct tm *t)
+{
+  int values[4];
+  get_time_digit_values(t, values);
+
   void (*function_to_run)(DIGIT);
   function_to_run = animate_digit;
   if (idle)
@@ -41,38 +75,27 @@ static void update_time(struct tm *t)
     function_to_run = update_digit_bitmap;
   }
 
-  int new_minute_2_value = t->tm_min % 10;
-  if (get_digit_value(MINUTE2) != new_minute_2_value)
+  if (get_digit_value(MINUTE2) != values[MINUTE2])
   {
-    update_digit_value(MINUTE2, new_minute_2_value);
+    update_digit_value(MINUTE2, values[MINUTE2]);
     function_to_run(MINUTE2);
   }
 
-  int new_minute_1_value = t->tm_min / 10;
-  if (get_digit_value(MINUTE1) != new_minute_1_value)
+  if (get_digit_value(MINUTE1) != values[MINUTE1])
   {
-    update_digit_value(MINUTE1, new_minute_1_value);
+    update_digit_value(MINUTE1, values[MINUTE1]);
     function_to_run(MINUTE1);
   }
 
-  int new_hour_2_value = hour % 10;
-  if (get_digit_value(HOUR2) != new_hour_2_value)
+  if (get_digit_value(HOUR2) != values[HOUR2])
   {
-    update_digit_value(HOUR2, new_hour_2_value);
+    update_digit_value(HOUR2, values[HOUR2]);
     function_to_run(HOUR2);
   }
 
-  int new_hour_1_value = hour / 10;
-  if (get_digit_value(HOUR1) != new_hour_1_value)
+  if (get_digit_value(HOUR1) != values[HOUR1])
   {
-    update_digit_value(HOUR1, new_hour_1_value);
-    function_to_run(HOUR1);
-  }
-
-  // Special case for 12-hour format when rolling from 12 to 1
-  if (!clock_is_24h_style() && get_digit_value(HOUR2) == 1 && get_digit_value(HOUR1) != 1)
-  {
-    update_digit_value(HOUR1, 0);
+    update_digit_value(HOUR1, values[HOUR1]);
     function_to_run(HOUR1);
   }
 }
@@ -87,6 +110,143 @@ static void update_time_now()
   update_time(t);
 }
 
+/**
+ * Logs the time from launch until the first stable frame
+ * @param warm Whether the frame was restored from the snapshot
+ */
+static void log_launch_time(bool warm)
+{
+  time_t now;
+  uint16_t now_ms;
+  time_ms(&now, &now_ms);
+  int elapsed = (int)(now - launch_time) * 1000 + now_ms - launch_time_ms;
+  APP_LOG(APP_LOG_LEVEL_INFO, "%s start: stable frame after %d ms", warm ? "Warm" : "Cold", elapsed);
+}
+
+/**
+ * Timer callback run once the first warm start frame has been drawn
+ * @param data Unused
+ */
+static void warm_frame_callback(void *data)
+{
+  log_launch_time(true);
+}
+
+/**
+ * Update proc for the background layer. Used to notice the first frame
+ * drawn on a warm start, so it is measured up to the same point as the
+ * intro on a cold start
+ * @param layer The layer being drawn. Unused
+ * @param ctx The graphics context. Unused
+ */
+static void background_update_proc(Layer *layer, GContext *ctx)
+{
+  if (!warm_frame_pending)
+    return;
+
+  // The frame is pushed to the display once drawing finishes, so log from the next event
+  warm_frame_pending = false;
+  app_timer_register(0, warm_frame_callback, NULL);
+}
+
+/**
+ * Logs how far from the minute boundary the last digit of a pre-roll landed
+ */
+static void log_preroll_landing()
+{
+  time_t now;
+  uint16_t now_ms;
+  time_ms(&now, &now_ms);
+  int error = (int)(now - preroll_target) * 1000 + now_ms;
+  int abs_error = error < 0 ? -error : error;
+
+  preroll_count++;
+  preroll_error_sum += abs_error;
+  if (abs_error > preroll_error_max)
+    preroll_error_max = abs_error;
+
+  APP_LOG(APP_LOG_LEVEL_INFO, "Pre-roll landed %d ms from the minute (mean %d ms, max %d ms over %d)",
+          error, preroll_error_sum / preroll_count, preroll_error_max, preroll_count);
+}
+
+/**
+ * Tracks digits landing in frame to report on the intro and pre-rolls
+ * @param digit The digit that landed. Unused
+ */
+static void digit_landed_handler(DIGIT digit)
+{
+  if (launch_pending > 0)
+  {
+    if (--launch_pending == 0)
+      log_launch_time(false);
+    return;
+  }
+
+  if (preroll_pending > 0 && --preroll_pending == 0)
+    log_preroll_landing();
+}
+
+/**
+ * Timer callback fired shortly before the minute changes. Preloads the bitmaps
+ * for the digits that are about to change and starts their transitions early
+ * @param data Unused
+ */
+static void preroll_callback(void *data)
+{
+  preroll_timer = NULL;
+  if (idle)
+    return;
+
+  // Too late to pre-roll once the boundary has passed, the minute tick handles it
+  time_t target = preroll_scheduled_target;
+  if (time(NULL) >= target)
+    return;
+
+  struct tm *t = localtime(&target);
+
+  int values[4];
+  get_time_digit_values(t, values);
+
+  preroll_pending = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    if (get_digit_value(i) != values[i])
+    {
+      preload_digit_bitmap(i, values[i]);
+      preroll_pending++;
+    }
+  }
+
+  preroll_target = target;
+  update_time(t);
+}
+
+/**
+ * Register a one-shot timer to pre-roll the digits ahead of the next minute
+ */
+static void register_preroll_timer()
+{
+  if (!PREROLL)
+    return;
+
+  time_t now;
+  uint16_t now_ms;
+  time_ms(&now, &now_ms);
+
+  // Wake up early enough for the whole transition to finish on the minute
+  time_t target = now - (now % 60) + 60;
+  int delay = 60000 - (int)(now % 60) * 1000 - now_ms - get_digit_transition_ms();
+  if (delay <= 0)
+  {
+    target += 60;
+    delay += 60000;
+  }
+
+  app_timer_cancel_safe(preroll_timer);
+  preroll_scheduled_target = target;
+  preroll_timer = app_timer_register(delay, preroll_callback, NULL);
+}
+
 /**
  * Tap handler to reset the idle timer
  * @param axis The axis of the tap. Unused
@@ -97,6 +257,14 @@ static void tap_handler(AccelAxisType axis, int32_t direction)
   register_idle_timer();
 }
 
+/**
+ * Wrist raise handler to reset the idle timer
+ */
+static void wake_handler()
+{
+  register_idle_timer();
+}
+
 /**
  * Bluetooth connection handler to vibrate on connection status change
  * @param connected Whether the connection is established
@@ -123,10 +291,61 @@ static void tick_handler(struct tm *tick_time, TimeUnits units_changed)
   // Update time every minute
   if (units_changed & MINUTE_UNIT)
   {
-    update_time(tick_time);
+    // Nothing left to change if the pre-roll already covered this minute
+    time_t now = time(NULL);
+    if (preroll_target != now - (now % 60))
+      update_time(tick_time);
+    register_preroll_timer();
+  }
+
+  if (WAKE_DETECTION && (units_changed & HOUR_UNIT))
+  {
+    wake_log_stats();
   }
 }
 
+/**
+ * Read the snapshot and decide whether it still matches the current minute
+ * and holds valid digits
+ */
+static void load_snapshot()
+{
+  warm_start = persist_read_data(PERSIST_KEY_SNAPSHOT, snapshot) == sizeof(Snapshot) &&
+               snapshot.version == SNAPSHOT_VERSION &&
+               snapshot.minute == (uint32_t)(time(NULL) / 60) &&
+               !(snapshot.flags & SNAPSHOT_FLAG_24H) == !clock_is_24h_style();
+
+  // The digits index the bitmap resources, so never trust a corrupt blob
+  for (int i = 0; warm_start && i < 4; i++)
+  {
+    if (snapshot.digits[i] > 9)
+      warm_start = false;
+  }
+}
+
+/**
+ * Save the displayed digits and the idle state so a relaunch within the same
+ * minute can redraw the last frame without the intro
+ */
+static void save_snapshot()
+{
+  time_t now = time(NULL);
+
+  // During a pre-roll the digits already show the upcoming minute
+  time_t shown = preroll_target > now ? preroll_target : now;
+
+  snapshot.version = SNAPSHOT_VERSION;
+  snapshot.flags = (idle ? SNAPSHOT_FLAG_IDLE : 0) | (clock_is_24h_style() ? SNAPSHOT_FLAG_24H : 0);
+  snapshot.minute = (uint32_t)(shown / 60);
+  snapshot.idle_deadline = (uint32_t)idle_deadline;
+  for (int i = 0; i < 4; i++)
+  {
+    snapshot.digits[i] = (uint8_t)get_digit_value(i);
+  }
+
+  persist_write_data(PERSIST_KEY_SNAPSHOT, snapshot);
+}
+
 /**
  * Main window load handler
  * @param window The window being loaded
@@ -146,13 +365,29 @@ static void main_window_load(Window *window)
   layer_add_to_window(background->parent_layer, window);
   bitmap_layer_add_to_layer(background->bitmap_layer, background->parent_layer);
 
+  if (warm_start)
+  {
+    // Draw the final frame straight away
+    for (int i = 0; i < 4; i++)
+    {
+      update_digit_value(i, snapshot.digits[i]);
+    }
+    load_digit_layers(true);
+    add_digit_layers_to_layer(background->parent_layer);
+
+    warm_frame_pending = true;
+    layer_set_update_proc(background->parent_layer, background_update_proc);
+    return;
+  }
+
   update_time_now();
 
   // Initialize digit layers
-  load_digit_layers();
+  load_digit_layers(false);
 
   add_digit_layers_to_layer(background->parent_layer);
 
+  launch_pending = 4;
   animate_digit(HOUR1);
   animate_digit(HOUR2);
   animate_digit(MINUTE1);
@@ -178,15 +413,26 @@ static void main_window_unload(Window *window)
  */
 static void init()
 {
+  time_ms(&launch_time, &launch_time_ms);
+  load_snapshot();
+  set_digit_landed_handler(digit_landed_handler);
+
   main_window = window_create();
   window_handlers(main_window, main_window_load, main_window_unload);
   window_stack_push(main_window, true);
 
   debug_tick_timer_service_subscribe(MINUTE_UNIT, tick_handler, REAL);
   accel_tap_service_subscribe(tap_handler);
+  if (WAKE_DETECTION)
+    wake_service_subscribe(wake_handler);
   bluetooth_connection_service_subscribe(bt_handler);
 
-  register_idle_timer();
+  if (warm_start)
+    restore_idle_timer();
+  else
+    register_idle_timer();
+
+  register_preroll_timer();
 }
 
 /**
@@ -194,9 +440,13 @@ static void init()
  */
 static void deinit()
 {
+  save_snapshot();
   debug_tick_timer_service_unsubscribe();
+  app_timer_cancel_safe(preroll_timer);
   animation_unschedule_all();
   accel_tap_service_unsubscribe();
+  if (WAKE_DETECTION)
+    wake_service_unsubscribe();
   bluetooth_connection_service_unsubscribe();
   window_destroy_safe(main_window);
 }
@@ -1,11 +1,88 @@
 #include "digits.h"
+#include "wake.h"
 
 static Window *main_window;
 static MaterialLayer *background;
 
 static AppTimer *timer = NULL;
+static AppTimer *preroll_timer = NULL;
+
+/**
+ * Whether to start digit transitions ahead of the minute so the new digits
+ * are fully in frame exactly when the minute changes
+ */
+#define PREROLL true
+
+/**
+ * Whether to leave idle when a wrist raise is detected, not only on a tap
+ */
+#define WAKE_DETECTION true
+
+/**
+ * Minute boundary the scheduled pre-roll timer is for
+ */
+static time_t preroll_scheduled_target = 0;
+
+/**
+ * Minute boundary the current pre-roll is aiming for and how many digits
+ * have yet to land on it
+ */
+static time_t preroll_target = 0;
+static int preroll_pending = 0;
+
+/**
+ * Landing error statistics for reporting how close pre-rolls land to the minute
+ */
+static int preroll_count = 0;
+static int preroll_error_sum = 0;
+static int preroll_error_max = 0;
 
 /**
  * Whether the watch has not been interacted with for a while
  */
 static bool idle = true;
+
+/**
+ * When the idle timer will set the idle flag
+ */
+static time_t idle_deadline = 0;
+
+/**
+ * Persist key and version of the warm-start snapshot
+ */
+#define PERSIST_KEY_SNAPSHOT 1
+#define SNAPSHOT_VERSION 1
+
+#define SNAPSHOT_FLAG_IDLE 1
+#define SNAPSHOT_FLAG_24H 2
+
+/**
+ * Everything needed to redraw the last displayed frame on relaunch
+ */
+typedef struct __attribute__((packed))
+{
+  uint8_t version;
+  uint8_t flags;
+  uint8_t digits[4];
+  uint32_t minute;
+  uint32_t idle_deadline;
+} Snapshot;
+
+/**
+ * Whether the app was relaunched within the minute saved in the snapshot
+ */
+static bool warm_start = false;
+static Snapshot snapshot;
+
+/**
+ * Launch time and the number of intro digits yet to land, for measuring the
+ * time until the first stable frame
+ */
+static time_t launch_time = 0;
+static uint16_t launch_time_ms = 0;
+static int launch_pending = 0;
+
+/**
+ * Whether the warm start frame has yet to be drawn for the first time
+ */
+static bool warm_frame_pending = false;
@@ -0,0 +1,176 @@
+#include "wake.h"
+
+// Define private
+// Sampling is kept slow and batched so the app is only woken every 2.5 seconds
+#define WAKE_SAMPLING_RATE ACCEL_SAMPLING_10HZ
+#define WAKE_SAMPLES_PER_BATCH 25
+
+// Viewing posture in milli-g: screen facing up and the arm roughly level
+#define VIEW_Z_MAX -600
+#define VIEW_X_LIMIT 600
+
+// The resting posture is a moving average of the samples, kept scaled by
+// POSTURE_DECAY so it stays in integers. Entering the viewing posture only
+// counts as a raise if the watch is at least CHANGE_MIN milli-g away from
+// it, which rules out jitter such as typing and slowly settling into view
+#define POSTURE_DECAY 8
+#define CHANGE_MIN 500
+
+// CHANGE_MIN and HOLD_SAMPLES were chosen against the synthetic tuning traces
+// in test/traces and have not been checked against real recordings
+
+// Samples the viewing posture must be held for (300ms at 10Hz)
+#define HOLD_SAMPLES 3
+
+/**
+ * Wakeup and detection counters for the wake service
+ */
+typedef struct
+{
+    time_t started;
+    int batches;
+    int samples;
+    int detections;
+} WakeStats;
+
+static WakeDetector detector;
+static WakeStats stats;
+static WakeHandler wake_handler = NULL;
+
+/**
+ * Absolute value of an integer
+ * @param value Value to return the absolute value of
+ */
+static int abs_int(int value)
+{
+    return value < 0 ? -value : value;
+}
+
+/**
+ * Reset a detector to its initial state
+ * @param detector The detector to reset
+ */
+void wake_detector_reset(WakeDetector *detector)
+{
+    memset(detector, 0, sizeof(WakeDetector));
+    detector->armed = true;
+}
+
+/**
+ * Classify a batch of samples. A wrist raise is a change in orientation that
+ * ends with the watch held in the viewing posture. The detector re-arms once
+ * the watch leaves the viewing posture, so holding it up only counts once
+ * @param detector The detector state to update
+ * @param data The accelerometer samples
+ * @param num_samples Number of samples in data
+ * @return Whether a wrist raise was detected in this batch
+ */
+bool wake_detector_process(WakeDetector *detector, const AccelData *data, uint32_t num_samples)
+{
+    bool detected = false;
+    for (uint32_t i = 0; i < num_samples; i++)
+    {
+        const AccelData *sample = &data[i];
+
+        // Samples taken while vibrating are noise from the motor
+        if (sample->did_vibrate)
+            continue;
+
+        if (!detector->has_posture)
+        {
+            detector->posture_x = sample->x * POSTURE_DECAY;
+            detector->posture_y = sample->y * POSTURE_DECAY;
+            detector->posture_z = sample->z * POSTURE_DECAY;
+            detector->has_posture = true;
+        }
+
+        int change = abs_int(sample->x - detector->posture_x / POSTURE_DECAY) +
+                     abs_int(sample->y - detector->posture_y / POSTURE_DECAY) +
+                     abs_int(sample->z - detector->posture_z / POSTURE_DECAY);
+
+        detector->posture_x += sample->x - detector->posture_x / POSTURE_DECAY;
+        detector->posture_y += sample->y - detector->posture_y / POSTURE_DECAY;
+        detector->posture_z += sample->z - detector->posture_z / POSTURE_DECAY;
+
+        bool viewing = sample->z <= VIEW_Z_MAX && abs_int(sample->x) <= VIEW_X_LIMIT;
+        if (!viewing)
+        {
+            detector->hold = 0;
+            detector->armed = true;
+            continue;
+        }
+
+        if (!detector->armed)
+            continue;
+
+        if (detector->hold == 0 && change < CHANGE_MIN)
+            continue;
+
+        if (++detector->hold >= HOLD_SAMPLES)
+        {
+            detected = true;
+            detector->armed = false;
+            detector->hold = 0;
+        }
+    }
+
+    return detected;
+}
+
+/**
+ * Handle a batch of accelerometer samples
+ * @param data The accelerometer samples
+ * @param num_samples Number of samples in data
+ */
+static void accel_data_handler(AccelData *data, uint32_t num_samples)
+{
+    stats.batches++;
+    stats.samples += num_samples;
+
+    if (wake_detector_process(&detector, data, num_samples))
+    {
+        stats.detections++;
+        if (wake_handler)
+            wake_handler();
+    }
+}
+
+/**
+ * Start detecting wrist raises
+ * @param handler Handler to call when a wrist raise is detected
+ */
+void wake_service_subscribe(WakeHandler handler)
+{
+    wake_handler = handler;
+    wake_detector_reset(&detector);
+    memset(&stats, 0, sizeof(WakeStats));
+    stats.started = time(NULL);
+
+    accel_data_service_subscribe(WAKE_SAMPLES_PER_BATCH, accel_data_handler);
+    accel_service_set_sampling_rate(WAKE_SAMPLING_RATE);
+}
+
+/**
+ * Stop detecting wrist raises
+ */
+void wake_service_unsubscribe()
+{
+    accel_data_service_unsubscribe();
+    wake_handler = NULL;
+}
+
+/**
+ * Log wakeups and detections per hour. The CPU cost per batch is too small
+ * to time on the watch and is measured by the host replay test instead
+ */
+void wake_log_stats()
+{
+    int elapsed = (int)(time(NULL) - stats.started);
+    if (elapsed <= 0 || stats.batches == 0)
+        return;
+
+    APP_LOG(APP_LOG_LEVEL_INFO, "Wake: %d wakeups/h, %d detections/h, %d samples per batch",
+            (int)((int64_t)stats.batches * 3600 / elapsed),
+            (int)((int64_t)stats.detections * 3600 / elapsed),
+            stats.samples / stats.batches);
+}
@@ -0,0 +1,26 @@
+#include "pebble.h"
+
+/**
+ * Handler called when a wrist raise has been detected
+ */
+typedef void (*WakeHandler)(void);
+
+/**
+ * State of the wrist raise classifier carried between sample batches.
+ * Only depends on AccelData so recorded traces can be replayed through it
+ */
+typedef struct
+{
+    bool has_posture;
+    int posture_x;
+    int posture_y;
+    int posture_z;
+    int hold;
+    bool armed;
+} WakeDetector;
+
+void wake_detector_reset(WakeDetector *detector);
+bool wake_detector_process(WakeDetector *detector, const AccelData *data, uint32_t num_samples);
+void wake_service_subscribe(WakeHandler handler);
+void wake_service_unsubscribe();
+void wake_log_stats();
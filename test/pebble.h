@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * Minimal stand-in for the Pebble SDK header so the wake detector can be
+ * built and replayed on the host
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    bool did_vibrate;
+    uint64_t timestamp;
+} AccelData;
+
+typedef void (*AccelDataHandler)(AccelData *data, uint32_t num_samples);
+
+typedef enum
+{
+    ACCEL_SAMPLING_10HZ = 10,
+    ACCEL_SAMPLING_25HZ = 25,
+    ACCEL_SAMPLING_50HZ = 50,
+    ACCEL_SAMPLING_100HZ = 100
+} AccelSamplingRate;
+
+#define APP_LOG_LEVEL_INFO 0
+#define APP_LOG(level, fmt, ...) printf(fmt "\n", ##__VA_ARGS__)
+
+static inline void accel_data_service_subscribe(uint32_t samples_per_update, AccelDataHandler handler) {}
+static inline void accel_data_service_unsubscribe() {}
+static inline int accel_service_set_sampling_rate(AccelSamplingRate rate) { return 0; }
@@ -0,0 +1,200 @@
+#include "../src/wake.c"
+
+#include <stdlib.h>
+
+#define MAX_SAMPLES 4096
+#define MAX_TRACES 64
+
+// Times every trace is replayed when measuring the cost per batch
+#define TIMING_ROUNDS 2000
+
+/**
+ * A recorded accelerometer trace and the number of wrist raises it contains
+ */
+typedef struct
+{
+    AccelData samples[MAX_SAMPLES];
+    uint32_t num_samples;
+    int raises;
+} Trace;
+
+/**
+ * Load a trace file. Lines starting with # are comments, except for
+ * "# raises: N" which gives the expected number of detections. Every other
+ * line is a sample as x,y,z,did_vibrate in milli-g
+ * @param path Path of the trace file
+ * @param trace Trace to load into
+ * @return Whether the trace was loaded
+ */
+static bool load_trace(const char *path, Trace *trace)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    trace->num_samples = 0;
+    trace->raises = -1;
+
+    char line[128];
+    while (fgets(line, sizeof(line), file))
+    {
+        if (line[0] == '#')
+        {
+            sscanf(line, "# raises: %d", &trace->raises);
+            continue;
+        }
+
+        int x, y, z, vibrate;
+        if (sscanf(line, "%d,%d,%d,%d", &x, &y, &z, &vibrate) != 4 || trace->num_samples == MAX_SAMPLES)
+            continue;
+
+        AccelData *sample = &trace->samples[trace->num_samples++];
+        memset(sample, 0, sizeof(AccelData));
+        sample->x = x;
+        sample->y = y;
+        sample->z = z;
+        sample->did_vibrate = vibrate;
+        sample->timestamp = (uint64_t)trace->num_samples * 1000 / WAKE_SAMPLING_RATE;
+    }
+
+    fclose(file);
+    return trace->raises >= 0;
+}
+
+/**
+ * Replay a trace through a fresh detector in batches, as the watch delivers them
+ * @param trace The trace to replay
+ * @return Number of wrist raises detected
+ */
+static int replay_trace(const Trace *trace)
+{
+    WakeDetector detector;
+    wake_detector_reset(&detector);
+
+    int detections = 0;
+    for (uint32_t i = 0; i < trace->num_samples; i += WAKE_SAMPLES_PER_BATCH)
+    {
+        uint32_t count = trace->num_samples - i;
+        if (count > WAKE_SAMPLES_PER_BATCH)
+            count = WAKE_SAMPLES_PER_BATCH;
+        if (wake_detector_process(&detector, &trace->samples[i], count))
+            detections++;
+    }
+
+    return detections;
+}
+
+/**
+ * Measure the CPU time per batch by replaying all traces many times, since
+ * a single batch is far too quick to time on its own
+ * @param traces The loaded traces
+ * @param num_traces Number of traces
+ * @return Nanoseconds per batch on this host
+ */
+static long time_batches(const Trace *traces, int num_traces)
+{
+    volatile int detections = 0;
+    long batches = 0;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int round = 0; round < TIMING_ROUNDS; round++)
+    {
+        for (int i = 0; i < num_traces; i++)
+        {
+            detections += replay_trace(&traces[i]);
+            batches += (traces[i].num_samples + WAKE_SAMPLES_PER_BATCH - 1) / WAKE_SAMPLES_PER_BATCH;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    long elapsed = (end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec);
+    return batches > 0 ? elapsed / batches : 0;
+}
+
+/**
+ * Replay a set of trace files and report how many raises were found and how
+ * many detections were false
+ * @param title Name of the set to print with its results
+ * @param paths Paths of the trace files
+ * @param count Number of paths
+ * @param traces Array to load the traces into
+ * @param num_traces Number of traces already loaded, updated as traces are added
+ * @return Number of traces that failed to load or did not match their expected raises
+ */
+static int replay_set(const char *title, char **paths, int count, Trace *traces, int *num_traces)
+{
+    int raises = 0, true_positives = 0, false_positives = 0;
+    int idle_traces = 0, idle_traces_woken = 0;
+    uint32_t samples = 0;
+    int failures = 0;
+
+    printf("%s\n", title);
+    for (int i = 0; i < count; i++)
+    {
+        if (*num_traces == MAX_TRACES || !load_trace(paths[i], &traces[*num_traces]))
+        {
+            printf("FAIL %s: unable to load trace\n", paths[i]);
+            failures++;
+            continue;
+        }
+
+        const Trace *trace = &traces[(*num_traces)++];
+        int detections = replay_trace(trace);
+        raises += trace->raises;
+        true_positives += detections < trace->raises ? detections : trace->raises;
+        false_positives += detections > trace->raises ? detections - trace->raises : 0;
+        samples += trace->num_samples;
+        if (trace->raises == 0)
+        {
+            idle_traces++;
+            if (detections > 0)
+                idle_traces_woken++;
+        }
+
+        bool passed = detections == trace->raises;
+        if (!passed)
+            failures++;
+        printf("%s %s: %d of %d raises detected\n", passed ? "ok  " : "MISS", paths[i], detections, trace->raises);
+    }
+
+    int hours_x100 = (int)((int64_t)samples * 100 / (WAKE_SAMPLING_RATE * 3600));
+    printf("True positive rate: %d/%d raises\n", true_positives, raises);
+    printf("False positive rate: %d/%d non-raise traces woken, %d false detections in %d.%02d h\n\n",
+           idle_traces_woken, idle_traces, false_positives, hours_x100 / 100, hours_x100 % 100);
+
+    return failures;
+}
+
+/**
+ * Replay the traces given on the command line. Traces before --heldout are
+ * the set the classifier constants were chosen against and must all pass.
+ * Traces after it were not used for tuning and are only reported
+ */
+int main(int argc, char **argv)
+{
+    static Trace traces[MAX_TRACES];
+    int num_traces = 0;
+
+    int split = argc;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--heldout") == 0)
+            split = i;
+    }
+
+    printf("NOTE: all traces are synthetic fixtures, not recordings from a real wrist.\n"
+           "These rates check the classifier against its own fixtures and say nothing\n"
+           "about real-world accuracy.\n\n");
+
+    int failures = replay_set("Tuning set (used to choose the classifier constants):",
+                              &argv[1], split - 1, traces, &num_traces);
+    if (split < argc)
+        replay_set("Held-out set (not used for tuning, reported only):",
+                   &argv[split + 1], argc - split - 1, traces, &num_traces);
+
+    printf("CPU time: %ld ns per batch of %d samples on this host\n",
+           time_batches(traces, num_traces), WAKE_SAMPLES_PER_BATCH);
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
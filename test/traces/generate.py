@@ -0,0 +1,123 @@
+import math, random, os, sys
+# Generates the synthetic accelerometer fixtures in test/traces. These are not
+# recordings from a real wrist. The tuning set was used to choose the
+# classifier constants, the held-out set in traces/heldout was written
+# afterwards and is only reported, never tuned against.
+#
+# Usage: python generate.py test/traces
+root = sys.argv[1]
+out = root
+HZ = 10
+HANG = (1000, 0, 0)          # arm hanging at the side, hand pointing down
+VIEW = (150, -550, -800)      # watch raised and tilted towards the face
+TABLE = (0, 0, -1000)        # flat on a table, screen up
+LAP = (-150, 950, -250)      # forearm resting on the lap, screen facing sideways
+TYPE = (0, -80, -990)        # wrist flat on a keyboard
+SIDE = (0, -980, -150)       # screen facing sideways, e.g. drinking
+
+class T:
+    def __init__(self, seed, noise):
+        self.r = random.Random(seed); self.s = []; self.noise = noise; self.pos = None; self.vib = False
+    def n(self, amp=None):
+        return int(round(self.r.gauss(0, self.noise if amp is None else amp)))
+    def hold(self, pos, secs, noise=None, vib=False):
+        for _ in range(int(secs * HZ)):
+            self.s.append((pos[0] + self.n(noise), pos[1] + self.n(noise), pos[2] + self.n(noise), vib))
+        self.pos = pos
+    def move(self, to, secs, swing=0):
+        a = self.pos; k = max(1, int(secs * HZ))
+        for i in range(1, k + 1):
+            f = (1 - math.cos(math.pi * i / k)) / 2
+            jolt = int(swing * math.sin(math.pi * i / k))
+            self.s.append(tuple(int(a[j] + (to[j] - a[j]) * f) + self.n() + (jolt if j == 1 else 0) for j in range(3)) + (False,))
+        self.pos = to
+    def walk(self, base, secs, amp=400, period=1.1):
+        for i in range(int(secs * HZ)):
+            ph = 2 * math.pi * i / (period * HZ)
+            self.s.append((base[0] + self.n(80) - int(abs(amp * math.sin(ph)) / 3), base[1] + int(amp * math.sin(ph)) + self.n(80), base[2] + int(amp / 2 * math.cos(ph)) + self.n(80), False))
+        self.pos = base
+    def twist(self, secs):
+        # Rotation about the forearm: screen sweeps from sideways through up and back
+        k = int(secs * HZ)
+        for i in range(k):
+            ang = math.pi * (-0.5 + i / (k - 1))
+            self.s.append((self.n(), int(-980 * math.sin(ang)) + self.n(), int(-980 * math.cos(ang)) + self.n(), False))
+        self.pos = (0, 980, 0)
+    def save(self, name, raises, desc):
+        os.makedirs(out, exist_ok=True)
+        with open(os.path.join(out, name + '.csv'), 'w') as f:
+            f.write('# ' + desc + '\n')
+            f.write('# Synthetic 10Hz trace in milli-g following the Pebble axis conventions\n')
+            f.write('# raises: %d\n' % raises)
+            for x, y, z, v in self.s:
+                f.write('%d,%d,%d,%d\n' % (x, y, z, 1 if v else 0))
+
+t = T(1, 25); t.hold(HANG, 4); t.move(VIEW, 0.8, 150); t.hold(VIEW, 3); t.move(HANG, 0.8); t.hold(HANG, 2)
+t.save('raise_from_side', 1, 'Standing with the arm at the side, raise to look, lower again')
+t = T(2, 25); t.hold(HANG, 3); t.move(VIEW, 0.4, 250); t.hold(VIEW, 2); t.move(HANG, 0.5); t.hold(HANG, 2)
+t.save('raise_quick', 1, 'Fast glance: raise in 0.4s, hold 2s')
+t = T(3, 20); t.hold(HANG, 3); t.move(VIEW, 1.6, 60); t.hold(VIEW, 3); t.move(HANG, 1.2); t.hold(HANG, 2)
+t.save('raise_slow', 1, 'Slow, deliberate raise over 1.6s')
+t = T(4, 30); t.walk(HANG, 6); t.move(VIEW, 0.8, 200); t.hold(VIEW, 3, 70); t.move(HANG, 0.6); t.walk(HANG, 4)
+t.save('raise_while_walking', 1, 'Walking with the arm swinging, raise to look while still walking')
+t = T(5, 20); t.hold(LAP, 5); t.move(VIEW, 0.9, 120); t.hold(VIEW, 3); t.move(LAP, 0.9); t.hold(LAP, 3)
+t.save('raise_from_lap', 1, 'Seated with the forearm on the lap, screen sideways, raise to look')
+t = T(6, 25); t.hold(HANG, 3); t.move(VIEW, 0.7, 150); t.hold(VIEW, 2); t.move(HANG, 0.7); t.hold(HANG, 5); t.move(VIEW, 0.7, 150); t.hold(VIEW, 2); t.move(HANG, 0.7); t.hold(HANG, 2)
+t.save('raise_twice', 2, 'Two separate glances with the arm lowered in between')
+t = T(7, 30); t.hold(TYPE, 4, 60); t.move(VIEW, 0.6, 300); t.hold(VIEW, 3); t.move(TYPE, 0.6); t.hold(TYPE, 3, 60)
+t.save('raise_from_keyboard', 1, 'Hands on a keyboard, lift the wrist towards the face to look')
+
+t = T(11, 8); t.hold(TABLE, 60)
+t.save('still_on_table', 0, 'Lying still on a table, screen up')
+t = T(12, 30); t.walk(HANG, 40)
+t.save('walking', 0, 'Walking with the arm swinging at the side')
+t = T(13, 60); t.hold(TYPE, 40, 60)
+t.save('typing', 0, 'Typing at a keyboard, wrist roughly level and screen up')
+t = T(14, 25); t.hold(HANG, 3); t.move(LAP, 1.2, 100); t.hold(LAP, 6); t.move(HANG, 1.0); t.hold(HANG, 3)
+t.save('sit_down', 0, 'Sitting down and resting the forearm on the lap')
+t = T(15, 25); t.hold(HANG, 3); t.move(SIDE, 0.8, 100); t.hold(SIDE, 3); t.move(HANG, 0.8); t.hold(HANG, 2)
+t.save('drinking', 0, 'Lifting a glass to drink, screen facing sideways')
+t = T(16, 25); t.hold(SIDE, 2); t.twist(0.3); t.hold((0, 980, 0), 1); t.move(SIDE, 0.3); t.hold(SIDE, 1); t.twist(0.3); t.hold((0, 980, 0), 2)
+t.save('door_handle', 0, 'Turning a door handle: the screen sweeps through facing up')
+t = T(17, 8); t.hold(TABLE, 5); t.hold(TABLE, 2, 400, True); t.hold(TABLE, 5); t.hold(TABLE, 2, 400, True); t.hold(TABLE, 5)
+t.save('vibrating_on_table', 0, 'Lying on a table while vibrating for notifications')
+
+# Held-out set: other wearers, viewing angles and activities, new seeds
+out = os.path.join(root, 'heldout')
+HANG_R = (-1000, 0, 0)         # right wrist, hand pointing down
+VIEW_R = (-150, -550, -800)    # right wrist raised towards the face
+VIEW_STEEP = (-50, -720, -680) # held high, screen tilted steeply
+VIEW_FLAT = (300, -380, -860)  # held low, screen nearly level
+CHEST = (100, -300, -940)      # lying on the back with the arm on the chest
+WHEEL = (-300, -900, -300)     # hands on a steering wheel
+
+t = T(101, 30); t.hold(HANG_R, 3); t.move(VIEW_R, 0.7, 150); t.hold(VIEW_R, 2.5); t.move(HANG_R, 0.7); t.hold(HANG_R, 2)
+t.save('raise_right_wrist', 1, 'Watch on the right wrist, raise to look')
+t = T(102, 35); t.hold(HANG, 3); t.move(VIEW_STEEP, 0.9, 200); t.hold(VIEW_STEEP, 2); t.move(HANG, 0.8); t.hold(HANG, 2)
+t.save('raise_steep', 1, 'Raise high with the screen tilted steeply towards the face')
+t = T(103, 35); t.hold(HANG, 3); t.move(VIEW_FLAT, 0.6, 120); t.hold(VIEW_FLAT, 2); t.move(HANG, 0.6); t.hold(HANG, 2)
+t.save('raise_low', 1, 'Raise only to chest height with the screen nearly level')
+t = T(104, 40); t.hold(TABLE, 4); t.move(VIEW, 0.7, 200); t.hold(VIEW, 2); t.move(TABLE, 0.7); t.hold(TABLE, 3)
+t.save('raise_from_table', 1, 'Forearm flat on a desk, lift it to look')
+t = T(105, 40); t.hold(HANG, 3); t.move(VIEW, 0.5, 200); t.hold(VIEW, 1); t.move(HANG, 0.5); t.hold(HANG, 3)
+t.save('glance_brief', 1, 'Very brief glance, held for one second')
+t = T(106, 45); t.walk(HANG_R, 5, 500, 0.9); t.move(VIEW_R, 0.7, 250); t.hold(VIEW_R, 2, 90); t.move(HANG_R, 0.6); t.walk(HANG_R, 4, 500, 0.9)
+t.save('raise_right_walking_fast', 1, 'Right wrist, brisk walk, raise to look while walking')
+
+t = T(111, 120); t.walk(HANG, 30, 800, 0.7)
+t.save('running', 0, 'Running with a strong arm swing')
+t = T(112, 50); t.hold(WHEEL, 10, 60); t.move((0, -700, -700), 1.2, 100); t.hold((0, -700, -700), 1.5, 60); t.move(WHEEL, 1.2); t.hold(WHEEL, 10, 60)
+t.save('driving', 0, 'Hands on the steering wheel with road vibration, turning through a corner')
+t = T(113, 20); t.hold(SIDE, 5); t.move(CHEST, 1.5, 80); t.hold(CHEST, 20, 20)
+t.save('lying_down', 0, 'Lying down and resting the arm on the chest')
+t = T(114, 40)
+t.hold(SIDE, 1)
+for _ in range(30):
+    t.move((0, -900, -300), 0.2); t.move((0, -900, 300), 0.2)
+t.save('brushing_teeth', 0, 'Brushing teeth: fast rotation of the forearm near the face')
+t = T(115, 30); t.hold(HANG, 3); t.move((0, -1000, 150), 0.9, 150); t.hold((0, -1000, 150), 3, 60); t.move(HANG, 0.9); t.hold(HANG, 2)
+t.save('scratching_head', 0, 'Raising the hand to the head, screen facing away')
+t = T(116, 30); t.hold(LAP, 3)
+for _ in range(15):
+    t.move((0, 900, -350), 0.2); t.move(LAP, 0.2)
+t.save('clapping', 0, 'Clapping with the forearms upright')